@@ -0,0 +1,123 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <Arduino.h>
+
+//========== PUERTOS AVR ==========
+// Cada puerto expone sus tres registros (PINx, DDRx, PORTx). Como son
+// direcciones fijas en el espacio de E/S, el compilador resuelve cada
+// acceso a una sola instrucción sbi/cbi/sbic/sbis.
+struct PortB {
+  static const char id = 'B';
+  static volatile uint8_t& in()  { return PINB; }
+  static volatile uint8_t& dir() { return DDRB; }
+  static volatile uint8_t& out() { return PORTB; }
+};
+
+struct PortC {
+  static const char id = 'C';
+  static volatile uint8_t& in()  { return PINC; }
+  static volatile uint8_t& dir() { return DDRC; }
+  static volatile uint8_t& out() { return PORTC; }
+};
+
+struct PortD {
+  static const char id = 'D';
+  static volatile uint8_t& in()  { return PIND; }
+  static volatile uint8_t& dir() { return DDRD; }
+  static volatile uint8_t& out() { return PORTD; }
+};
+
+//========== MAPA DE PINES DEL ATmega328P ==========
+// Puerto y bit de cada número de pin Arduino (Uno/Nano): D0-D7 en PORTD,
+// D8-D13 en PORTB y A0-A5 (14-19) en PORTC. Sirve para verificar en
+// compilación que cada Pin<> de una placa esté bien escrito.
+constexpr char unoPortOf(uint8_t number) {
+  return number < 8 ? 'D' : (number < 14 ? 'B' : (number < 20 ? 'C' : '?'));
+}
+
+constexpr uint8_t unoBitOf(uint8_t number) {
+  return number < 8 ? number : (number < 14 ? number - 8 : number - 14);
+}
+
+//========== PIN EN TIEMPO DE COMPILACIÓN ==========
+// Pin<numero, Puerto, bit>: el número Arduino se conserva para las librerías
+// que lo piden (tone(), Adafruit_NeoPixel, Keypad); el resto de los accesos
+// van directo al puerto sin pasar por las tablas de digitalRead/digitalWrite.
+//
+// Costo aproximado por acceso (ATmega328P a 16 MHz, contando instrucciones):
+//   digitalRead(pin)        ~50-60 ciclos (3 tablas en flash + chequeo de PWM)
+//   digitalWrite(pin, val)  ~55-70 ciclos (igual + cli/sei alrededor del RMW)
+//   Pin::read()             1-2 ciclos (sbis + salto)
+//   Pin::high() / low()     2 ciclos (sbi / cbi, atómicos, sin cli)
+template <uint8_t Number, class Port, uint8_t Bit>
+struct Pin {
+  static const uint8_t number = Number;   // Número de pin Arduino
+  static const uint8_t mask = 1 << Bit;   // Máscara dentro del puerto
+  static const bool wired =                // El número coincide con puerto/bit
+    Port::id == unoPortOf(Number) && Bit == unoBitOf(Number);
+
+  static void output() { Port::dir() |= mask; }
+  static void input()  { Port::dir() &= ~mask; Port::out() &= ~mask; }
+  static void high()   { Port::out() |= mask; }
+  static void low()    { Port::out() &= ~mask; }
+  static void write(bool value) { if (value) high(); else low(); }
+  static bool read()   { return (Port::in() & mask) != 0; }
+};
+
+//========== LISTA DE PINES ==========
+// Números Arduino de un grupo de pines (filas/columnas del teclado). La
+// cantidad sale del propio paquete, así la geometría queda en el tipo.
+template <uint8_t... Numbers>
+struct PinList {
+  static const uint8_t count = sizeof...(Numbers);
+  static byte numbers[sizeof...(Numbers)];  // Keypad pide byte* no const
+};
+
+template <uint8_t... Numbers>
+byte PinList<Numbers...>::numbers[sizeof...(Numbers)] = {Numbers...};
+
+//========== DESCRIPCIÓN DE PLACA ==========
+// Agrupa todos los periféricos de una placa. Nada de esto ocupa RAM ni
+// código en tiempo de ejecución: son sólo tipos y constantes.
+template <class Light, class Buzzer, class Ring, class Door,
+          uint16_t NumPixels, class RowPinList, class ColPinList>
+struct BoardLayout {
+  typedef Light LightPin;       // Luz interna
+  typedef Buzzer BuzzerPin;     // Buzzer
+  typedef Ring RingPin;         // Entrada de datos del anillo NeoPixel
+  typedef Door DoorPin;         // HIGH = puerta cerrada, LOW = puerta abierta
+  typedef RowPinList RowPins;   // Filas del teclado
+  typedef ColPinList ColPins;   // Columnas del teclado
+
+  static const uint16_t numPixels = NumPixels;       // LEDs del anillo
+  static const uint8_t rows = RowPinList::count;     // Filas del teclado
+  static const uint8_t cols = ColPinList::count;     // Columnas del teclado
+
+  static_assert(Light::wired, "Luz: el numero de pin no coincide con puerto/bit");
+  static_assert(Buzzer::wired, "Buzzer: el numero de pin no coincide con puerto/bit");
+  static_assert(Ring::wired, "Anillo: el numero de pin no coincide con puerto/bit");
+  static_assert(Door::wired, "Puerta: el numero de pin no coincide con puerto/bit");
+};
+
+//========== PLACAS DISPONIBLES ==========
+// Arduino Uno como está cableado en diagram.json (simulación Wokwi)
+typedef BoardLayout<
+  Pin<4,  PortD, 4>,              // Luz interna     (D4)
+  Pin<2,  PortD, 2>,              // Buzzer          (D2)
+  Pin<A5, PortC, 5>,              // Anillo NeoPixel (A5)
+  Pin<A1, PortC, 1>,              // Sensor puerta   (A1)
+  16,                             // LEDs del anillo
+  PinList<13, 12, 11, 10>,        // Filas del teclado
+  PinList<9, 8, 7, 6>             // Columnas del teclado
+> UnoWokwiBoard;
+
+// Placa activa: se cambia desde platformio.ini con
+//   build_flags = -D MICROONDAS_BOARD=OtraPlaca
+#ifndef MICROONDAS_BOARD
+#define MICROONDAS_BOARD UnoWokwiBoard
+#endif
+
+typedef MICROONDAS_BOARD Board;
+
+#endif
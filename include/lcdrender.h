@@ -0,0 +1,33 @@
+#ifndef LCDRENDER_H
+#define LCDRENDER_H
+
+#include <Arduino.h>
+#include <LiquidCrystal_I2C.h>
+
+//========== PANTALLA DE COCCIÓN ==========
+// Dibuja la pantalla de cocción con glifos propios y manda al LCD sólo las
+// celdas que cambiaron respecto del último cuadro.
+//
+//   columna: 0 1 2 3 4 5 6 7 ............ 15
+//   fila 0:  m m : s s   F [barra de fase  ]
+//   fila 1:  m m : s s   P [barra total    ]
+//
+// mm:ss son dígitos de doble altura con el tiempo restante de la fase (desde
+// 100 minutos pasa a horas y minutos, con una 'h' en lugar del ':'), F es
+// la fase ('C' calentando, 'E' esperando) y P el programa ('A'-'D', 'R' para
+// cocción rápida). Las barras tienen resolución de un píxel (5 por celda).
+
+// Datos de un cuadro
+struct CookScreen {
+  int remaining;              // Segundos restantes de la fase
+  int phaseTotal;             // Duración de la fase en segundos
+  bool cooling;               // true = enfriando, false = calentando
+  char program;               // Letra del programa
+  unsigned long done;         // Segundos transcurridos de todo el programa
+  unsigned long total;        // Duración total del programa (todas las repeticiones)
+};
+
+void cookScreenReset();       // Otro código escribió en el LCD: redibujar todo
+void cookScreenRender(LiquidCrystal_I2C& lcd, const CookScreen& screen);
+
+#endif
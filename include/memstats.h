@@ -0,0 +1,19 @@
+#ifndef MEMSTATS_H
+#define MEMSTATS_H
+
+#include <Arduino.h>
+
+//========== USO DE SRAM ==========
+// Al arrancar se pinta toda la RAM libre (entre el final de .bss y RAMEND)
+// con un patrón. El heap y el stack lo van pisando; lo que queda sin pisar
+// es el margen mínimo que hubo entre ambos desde el arranque.
+
+// Por debajo de este margen se avisa por serie (una sola vez)
+const uint16_t MEMORY_WARN_THRESHOLD = 128;
+
+uint16_t memoryFreeNow();       // Bytes entre el tope del heap y el stack actual
+uint16_t memoryMinFree();       // Bytes nunca tocados desde el arranque
+void memoryUpdate();            // Muestreo periódico y aviso de margen bajo
+void memoryReport(Print& out);  // Imprime el resumen de memoria
+
+#endif
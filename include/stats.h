@@ -0,0 +1,34 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <Arduino.h>
+
+//========== ESTADÍSTICAS DE USO ==========
+// Contadores en RAM que se vuelcan de vez en cuando a un anillo de registros
+// en la EEPROM. Cada registro guarda sólo lo que cambió desde el anterior.
+
+// Campos contados (el orden es parte del formato en EEPROM, no cambiarlo)
+enum StatsField {
+  STAT_PROGRAM_A = 0,           // Programas A-D: índices 0 a 3
+  STAT_QUICK_1 = 4,             // Cocción rápida 1-9: índices 4 a 12
+  STAT_MAGNETRON_SECONDS = 13,  // Segundos en fase de calentamiento
+  STAT_DOOR_OPEN_COOKING = 14,  // Aperturas de puerta durante la cocción
+  STAT_CANCELLED = 15,          // Cocciones canceladas con *
+  STAT_FIELDS = 16              // Cantidad de campos
+};
+
+// Contadores pendientes de volcar a la EEPROM
+extern uint16_t statsPending[STAT_FIELDS];
+
+// Suma un evento. Con un campo constante son unas pocas instrucciones
+// (lds/adiw/sts), así que se puede llamar desde cualquier estado.
+inline void statsCount(uint8_t field) {
+  statsPending[field]++;
+}
+
+void statsBegin();              // Busca la posición de escritura del anillo
+void statsUpdate(bool idle);    // Vuelca a EEPROM si pasó el intervalo
+void statsFlush();              // Fuerza el volcado de lo pendiente
+void statsDump(Print& out);     // Imprime el anillo y lo pendiente
+
+#endif
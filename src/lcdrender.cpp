@@ -0,0 +1,231 @@
+#include "lcdrender.h"
+
+const uint8_t LCD_COLS = 16;
+const uint8_t LCD_ROWS = 2;
+const uint8_t LCD_CELLS = LCD_COLS * LCD_ROWS;
+const uint8_t CGRAM_SLOTS = 8;            // Glifos propios que admite el HD44780
+
+const uint8_t BAR_COL = 7;                         // Primera celda de las barras
+const uint8_t BAR_CELLS = LCD_COLS - BAR_COL;      // Celdas por barra
+const uint8_t BAR_PIXELS = BAR_CELLS * 5;          // Resolución de cada barra
+
+//========== FORMAS ==========
+// En el cuadro, los códigos menores a 0x20 son formas propias que después se
+// traducen al slot de CGRAM donde están cargadas; el resto son de la ROM.
+//   0x01-0x0F: mitad de dígito, combinación de bordes EDGE_*
+//   0x11-0x14: celda de barra con 1 a 4 columnas llenas
+const uint8_t EDGE_LEFT = 0x01;
+const uint8_t EDGE_RIGHT = 0x02;
+const uint8_t EDGE_TOP = 0x04;
+const uint8_t EDGE_BOTTOM = 0x08;
+const uint8_t BAR_SHAPE = 0x10;
+const uint8_t FIRST_ROM_CHAR = 0x20;
+const uint8_t FULL_BLOCK = 0xFF;          // Bloque lleno de la ROM
+const uint8_t MIDDLE_DOT = 0xA5;          // Punto medio de la ROM A00 (para el ':')
+
+// Dígitos de 7 segmentos en dos celdas. El segmento del medio va abajo de la
+// mitad superior o arriba de la inferior según el dígito, así todos los
+// dígitos salen con sólo 8 formas distintas.
+const uint8_t digitTop[10] PROGMEM = {
+  EDGE_TOP | EDGE_LEFT | EDGE_RIGHT,                  // 0
+  EDGE_RIGHT,                                         // 1
+  EDGE_TOP | EDGE_RIGHT | EDGE_BOTTOM,                // 2
+  EDGE_TOP | EDGE_RIGHT,                              // 3
+  EDGE_LEFT | EDGE_RIGHT | EDGE_BOTTOM,               // 4
+  EDGE_TOP | EDGE_LEFT,                               // 5
+  EDGE_TOP | EDGE_LEFT,                               // 6
+  EDGE_TOP | EDGE_RIGHT,                              // 7
+  EDGE_TOP | EDGE_LEFT | EDGE_RIGHT | EDGE_BOTTOM,    // 8
+  EDGE_TOP | EDGE_LEFT | EDGE_RIGHT                   // 9
+};
+
+const uint8_t digitBottom[10] PROGMEM = {
+  EDGE_LEFT | EDGE_RIGHT | EDGE_BOTTOM,               // 0
+  EDGE_RIGHT,                                         // 1
+  EDGE_LEFT | EDGE_BOTTOM,                            // 2
+  EDGE_TOP | EDGE_RIGHT | EDGE_BOTTOM,                // 3
+  EDGE_RIGHT,                                         // 4
+  EDGE_TOP | EDGE_RIGHT | EDGE_BOTTOM,                // 5
+  EDGE_TOP | EDGE_LEFT | EDGE_RIGHT | EDGE_BOTTOM,    // 6
+  EDGE_RIGHT,                                         // 7
+  EDGE_LEFT | EDGE_RIGHT | EDGE_BOTTOM,               // 8
+  EDGE_TOP | EDGE_RIGHT | EDGE_BOTTOM                 // 9
+};
+
+//========== ESTADO DEL LCD ==========
+uint8_t shownCells[LCD_CELLS];            // Código enviado a cada celda
+uint8_t slotShape[CGRAM_SLOTS];           // Forma cargada en cada slot (0 = libre)
+uint8_t slotLastUse[CGRAM_SLOTS];         // Cuadro en que se usó cada slot por última vez
+uint8_t frameCount = 0;                   // Contador de cuadros (da la vuelta)
+bool cookScreenValid = false;             // false = el LCD tiene otra cosa
+
+void cookScreenReset() {
+  cookScreenValid = false;
+}
+
+// Carga el mapa de bits de una forma en un slot de CGRAM
+static void loadShape(LiquidCrystal_I2C& lcd, uint8_t slot, uint8_t shape) {
+  uint8_t rows[8];
+
+  for (uint8_t r = 0; r < 8; r++) {
+    if (shape & BAR_SHAPE) {
+      rows[r] = (0x1F << (5 - (shape & 0x07))) & 0x1F;  // Columnas desde la izquierda
+    } else {
+      rows[r] = (shape & EDGE_LEFT ? 0x10 : 0) | (shape & EDGE_RIGHT ? 0x01 : 0);
+    }
+  }
+  if (!(shape & BAR_SHAPE)) {
+    if (shape & EDGE_TOP) rows[0] = 0x1F;
+    if (shape & EDGE_BOTTOM) rows[7] = 0x1F;
+  }
+
+  lcd.createChar(slot, rows);
+  slotShape[slot] = shape;
+}
+
+// Slot donde está cargada una forma (-1 si no está)
+static int8_t findSlot(uint8_t shape) {
+  for (uint8_t s = 0; s < CGRAM_SLOTS; s++) {
+    if (slotShape[s] == shape) return s;
+  }
+  return -1;
+}
+
+// Slot a reemplazar: uno vacío si hay, si no el que hace más que no se usa
+// entre los que este cuadro no necesita
+static int8_t victimSlot(const bool* used) {
+  int8_t victim = -1;
+  uint8_t oldest = 0;
+
+  for (uint8_t s = 0; s < CGRAM_SLOTS; s++) {
+    if (used[s]) continue;
+    if (slotShape[s] == 0) return s;
+    uint8_t age = frameCount - slotLastUse[s];
+    if (victim < 0 || age > oldest) {
+      victim = s;
+      oldest = age;
+    }
+  }
+  return victim;
+}
+
+// Reemplaza las formas del cuadro por slots de CGRAM y carga las que falten.
+// Hay 12 formas y 8 slots: si un cuadro necesita más de 8, las celdas
+// parciales de las barras se redondean a celda llena o vacía.
+static void assignSlots(LiquidCrystal_I2C& lcd, uint8_t* frame) {
+  uint8_t shapes[CGRAM_SLOTS + 2];  // 8 mitades de dígito + 2 celdas de barra
+  uint8_t count = 0;
+
+  for (uint8_t i = 0; i < LCD_CELLS; i++) {
+    if (frame[i] >= FIRST_ROM_CHAR) continue;
+    uint8_t n = 0;
+    while (n < count && shapes[n] != frame[i]) n++;
+    if (n == count && count < sizeof(shapes)) shapes[count++] = frame[i];
+  }
+
+  if (count > CGRAM_SLOTS) {
+    for (uint8_t i = 0; i < LCD_CELLS; i++) {
+      if (frame[i] < FIRST_ROM_CHAR && (frame[i] & BAR_SHAPE)) {
+        frame[i] = (frame[i] & 0x07) >= 3 ? FULL_BLOCK : ' ';
+      }
+    }
+  }
+
+  // Los slots que ya tienen una forma de este cuadro no se pisan
+  bool used[CGRAM_SLOTS] = {false};
+  for (uint8_t i = 0; i < LCD_CELLS; i++) {
+    if (frame[i] >= FIRST_ROM_CHAR) continue;
+    int8_t s = findSlot(frame[i]);
+    if (s >= 0) used[s] = true;
+  }
+
+  frameCount++;
+
+  for (uint8_t i = 0; i < LCD_CELLS; i++) {
+    if (frame[i] >= FIRST_ROM_CHAR) continue;
+    int8_t s = findSlot(frame[i]);
+    if (s < 0) {
+      s = victimSlot(used);
+      loadShape(lcd, s, frame[i]);
+      used[s] = true;
+    }
+    slotLastUse[s] = frameCount;
+    frame[i] = s;
+  }
+}
+
+// Dibuja una barra de progreso en la fila dada
+static void drawBar(uint8_t* row, unsigned long done, unsigned long total) {
+  // Achica ambos valores para que done * BAR_PIXELS no desborde
+  while (total > 0xFFFFFFUL) {
+    total >>= 1;
+    done >>= 1;
+  }
+  uint8_t pixels = total ? min(done, total) * BAR_PIXELS / total : 0;
+
+  for (uint8_t c = 0; c < BAR_CELLS; c++) {
+    uint8_t fill = min(pixels, 5);
+    pixels -= fill;
+    if (fill == 5) {
+      row[BAR_COL + c] = FULL_BLOCK;
+    } else if (fill == 0) {
+      row[BAR_COL + c] = ' ';
+    } else {
+      row[BAR_COL + c] = BAR_SHAPE | fill;
+    }
+  }
+}
+
+void cookScreenRender(LiquidCrystal_I2C& lcd, const CookScreen& screen) {
+  uint8_t frame[LCD_CELLS];
+  memset(frame, ' ', sizeof(frame));
+
+  // Tiempo restante de doble altura: mm:ss hasta 99:59 y hhHmm desde 100
+  // minutos (la configuración admite hasta 9999 s)
+  unsigned int seconds = max(screen.remaining, 0);
+  bool hours = seconds >= 6000;
+  unsigned int high = hours ? seconds / 3600 : seconds / 60;
+  unsigned int low = hours ? seconds / 60 % 60 : seconds % 60;
+  const uint8_t digitCols[4] = {0, 1, 3, 4};
+  uint8_t digits[4] = {
+    (uint8_t)(high / 10 % 10),
+    (uint8_t)(high % 10),
+    (uint8_t)(low / 10),
+    (uint8_t)(low % 10)
+  };
+  for (uint8_t i = 0; i < 4; i++) {
+    frame[digitCols[i]] = pgm_read_byte(&digitTop[digits[i]]);
+    frame[LCD_COLS + digitCols[i]] = pgm_read_byte(&digitBottom[digits[i]]);
+  }
+  if (hours) {
+    frame[LCD_COLS + 2] = 'h';
+  } else {
+    frame[2] = MIDDLE_DOT;
+    frame[LCD_COLS + 2] = MIDDLE_DOT;
+  }
+
+  // Fase y barra de la fase en la fila 0, programa y barra total en la fila 1
+  frame[BAR_COL - 1] = screen.cooling ? 'E' : 'C';
+  frame[LCD_COLS + BAR_COL - 1] = screen.program;
+  drawBar(frame, screen.phaseTotal - screen.remaining, screen.phaseTotal);
+  drawBar(frame + LCD_COLS, screen.done, screen.total);
+
+  if (!cookScreenValid) {
+    lcd.clear();
+    memset(shownCells, ' ', sizeof(shownCells));
+    cookScreenValid = true;
+  }
+
+  assignSlots(lcd, frame);
+
+  // Manda sólo las celdas distintas; si son contiguas en la misma fila se
+  // aprovecha el avance automático del cursor y no se reposiciona
+  int8_t cursor = -1;
+  for (uint8_t i = 0; i < LCD_CELLS; i++) {
+    if (frame[i] == shownCells[i]) continue;
+    if (i != cursor) lcd.setCursor(i % LCD_COLS, i / LCD_COLS);
+    lcd.write(frame[i]);
+    shownCells[i] = frame[i];
+    cursor = (i + 1) % LCD_COLS ? i + 1 : -1;
+  }
+}
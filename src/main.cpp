@@ -2,6 +2,10 @@
 #include <Keypad.h>
 #include <Adafruit_NeoPixel.h>
 #include <LiquidCrystal_I2C.h>
+#include "board.h"
+#include "stats.h"
+#include "memstats.h"
+#include "lcdrender.h"
 
 //============PROTOTIPOS DE FUNCIONES===========
 // Acá están todas las declaraciones de funciones que vamos a usar después
@@ -26,20 +30,21 @@ void updateRotatingPattern();  // Patrón giratorio para cocción
 void updateBlinkingPattern();  // Patrón de parpadeo para enfriamiento
 void updateBuzzer();  // Controla el buzzer
 void handleFinishedBeep();  // Sonido de finalización
+void handleSerialCommand();  // Atiende comandos por el puerto serie
+void showCookScreen(int remaining);  // Dibuja la pantalla de cocción
 
 //========== LCD DISPLAY ===========
 // Pantalla LCD con interfaz I2C (dirección 0x27, 16 columnas x 2 filas)
 LiquidCrystal_I2C lcd(0x27, 16, 2);
 
 //========== LUZ INTERNA ==========
-const byte lightPin = 4;  // Pin para controlar la luz del microondas
+typedef Board::LightPin LightPin;  // Pin para controlar la luz del microondas
 
 //========== TECLADO ==========
-// Configuración del keypad matricial 4x4
-const int ROWS = 4;
-const int COLS = 4;
-byte rowPins[ROWS] = {13, 12, 11, 10};  // Pines de filas
-byte colPins[COLS] = {9, 8, 7, 6};  // Pines de columnas
+// Configuración del keypad matricial (geometría y pines según la placa)
+const int ROWS = Board::rows;
+const int COLS = Board::cols;
+static_assert(ROWS == 4 && COLS == 4, "El mapa de teclas de abajo es de 4x4");
 
 // Mapeo de teclas
 char keys[ROWS][COLS] = {
@@ -49,18 +54,18 @@ char keys[ROWS][COLS] = {
   {'*','0','#','D'}   // Fila 4
 };
 
-Keypad keypad = Keypad(makeKeymap(keys), rowPins, colPins, ROWS, COLS);
+Keypad keypad = Keypad(makeKeymap(keys), Board::RowPins::numbers, Board::ColPins::numbers, ROWS, COLS);
 
 //========== BUZZER ==========
-const int buzzerPin = 2;  // Pin del buzzer
+typedef Board::BuzzerPin BuzzerPin;  // Pin del buzzer
 
 //========== ANILLO NEOPIXEL ==========
-const byte ringPin = A5;  // Pin del anillo de LEDs
-const int numPixels = 16;  // Cantidad de LEDs en el anillo
-Adafruit_NeoPixel ring = Adafruit_NeoPixel(numPixels, ringPin, NEO_GRB + NEO_KHZ800);
+typedef Board::RingPin RingPin;  // Pin del anillo de LEDs
+const int numPixels = Board::numPixels;  // Cantidad de LEDs en el anillo
+Adafruit_NeoPixel ring = Adafruit_NeoPixel(numPixels, RingPin::number, NEO_GRB + NEO_KHZ800);
 
 //========== SENSOR DE PUERTA ==========
-const byte doorPin = A1;  // HIGH = puerta cerrada, LOW = puerta abierta
+typedef Board::DoorPin DoorPin;  // HIGH = puerta cerrada, LOW = puerta abierta
 
 //========== ENUMS (ENUMERACIONES) ==========
 // Estados posibles del microondas
@@ -189,24 +194,28 @@ void loadFromEEPROM() {
 void setup() {
   Serial.begin(9600);  // Inicia comunicación serial
   lcd.begin(16, 2);    // Inicia LCD
-  pinMode(doorPin, INPUT);  // Configura pin de puerta como entrada
-  pinMode(lightPin, OUTPUT);  // Configura pin de luz como salida
-  pinMode(buzzerPin, OUTPUT);  // Configura pin de buzzer como salida
+  DoorPin::input();  // Configura pin de puerta como entrada
+  LightPin::output();  // Configura pin de luz como salida
+  BuzzerPin::output();  // Configura pin de buzzer como salida
   ring.begin();       // Inicia anillo de LEDs
   ring.show();        // Muestra estado inicial (apagado)
   
   // Simulación de datos en EEPROM
   saveDefaultProgramsToEEPROM();  // Guarda programas por defecto
   loadFromEEPROM();               // Carga programas desde EEPROM
+  statsBegin();                   // Ubica el anillo de estadísticas
 }
 
 //========== LOOP PRINCIPAL ==========
 void loop() {
   // Primero verificamos el estado de la puerta
-  bool doorClosed = digitalRead(doorPin) == HIGH;
+  bool doorClosed = DoorPin::read();
   
   // Lógica para manejar cambios de estado por apertura/cierre de puerta
   if (!doorClosed && currentState != DOOR_OPEN) {
+    if (currentState == COOKING) {
+      statsCount(STAT_DOOR_OPEN_COOKING);  // Puerta abierta en plena cocción
+    }
     prevState = currentState;    // Guarda estado actual antes de cambiar
     currentState = DOOR_OPEN;    // Cambia a estado puerta abierta
     screenInitialized = false;   // Fuerza refresco de pantalla
@@ -223,6 +232,9 @@ void loop() {
   updateInteriorLight();       // Actualiza luz interna
   updatePlatePattern();        // Actualiza patrones del anillo
   updateBuzzer();             // Actualiza estado del buzzer
+  statsUpdate(currentState == WAITING);  // Vuelca estadísticas en reposo
+  memoryUpdate();             // Vigila el margen entre heap y stack
+  handleSerialCommand();      // Comandos por serie (estadísticas, memoria)
 }
 
 //========== MANEJO DE ESTADOS ==========
@@ -268,6 +280,7 @@ void handleWaitingState(char key) {
   } else if (key >= 'A' && key <= 'D') {
     // Teclas A-D inician programas predefinidos
     int index = key - 'A';  // Convierte a índice (0-3)
+    statsCount(STAT_PROGRAM_A + index);
     startCookingProgram(
       index,
       cookingPrograms[index].cookTime,
@@ -278,6 +291,7 @@ void handleWaitingState(char key) {
   else if (key >= '1' && key <= '9') {
     // Teclas 1-9 inician cocción rápida
     int cookSeconds = key - '0';  // Convierte char a int
+    statsCount(STAT_QUICK_1 + cookSeconds - 1);
     currentProgramIndex = -1;     // Indica que es programa de usuario
     startCookingProgram(-1, cookSeconds, 0, 1);
   }
@@ -379,7 +393,7 @@ void handleConfiguringState(char key) {
 
 // Maneja estado de cocción activa
 void handleCookingState() {
-  bool doorClosed = digitalRead(doorPin) == HIGH;
+  bool doorClosed = DoorPin::read();
 
   // Verificación de puerta abierta durante cocción
   if (!doorClosed) {
@@ -396,22 +410,12 @@ void handleCookingState() {
   if (now - lastTimerUpdate >= timerInterval) {
     lastTimerUpdate = now;
 
-    // Muestra nombre del programa en LCD
-    lcd.setCursor(0, 0);
-    if (currentProgramIndex >= 0) {
-      lcd.print(cookingPrograms[currentProgramIndex].label);
-    } else {
-      lcd.print("Coccion Rapida ");
-    }
-
     // Manejo de tiempos según fase (cocción/enfriamiento)
     if (currentStep == 0) {  // Fase de cocción
       if (currentCookTime >= 0) {
-        lcd.setCursor(0, 1);
-        lcd.print("Calentando:");
-        lcd.print(currentCookTime);
-        lcd.print(" s  ");
+        showCookScreen(currentCookTime);
         currentCookTime--;
+        statsCount(STAT_MAGNETRON_SECONDS);  // Un segundo más de magnetrón
       } else {
         // Transición a enfriamiento o repetición
         if (currentCoolTime > 0) {
@@ -438,10 +442,7 @@ void handleCookingState() {
       }
     } else if (currentStep == 1) {  // Fase de enfriamiento
       if (currentCoolTime >= 0) {
-        lcd.setCursor(0, 1);
-        lcd.print("Esperando: ");
-        lcd.print(currentCoolTime);
-        lcd.print(" s  ");
+        showCookScreen(currentCoolTime);
         currentCoolTime--;
       } else {
         currentRepetitions--;
@@ -468,7 +469,7 @@ void handleCookingState() {
 
 // Maneja estado pausado
 void handlePausedState() {
-  bool doorClosed = digitalRead(doorPin) == HIGH;
+  bool doorClosed = DoorPin::read();
 
   // Si se cierra la puerta, reanuda la cocción
   if (doorClosed) {
@@ -476,6 +477,7 @@ void handlePausedState() {
     currentState = COOKING;
     lcd.clear();
     lcd.print("Reanudando");
+    cookScreenReset();  // La pantalla de cocción se redibuja entera
     delay(1000);
     lastTimerUpdate = millis();  // Actualiza timer sin reiniciar valores
   }
@@ -496,8 +498,26 @@ void resetConfiguration() {
   currentState = WAITING;
 }
 
+// Arma el cuadro de la pantalla de cocción a partir del estado actual
+void showCookScreen(int remaining) {
+  CookScreen screen;
+  unsigned long perRepetition = cookTime + coolTime;
+
+  screen.cooling = (currentStep == 1);
+  screen.phaseTotal = screen.cooling ? coolTime : cookTime;
+  screen.remaining = remaining;
+  screen.program = currentProgramIndex >= 0 ? 'A' + currentProgramIndex : 'R';
+  screen.done = (repetitions - currentRepetitions) * perRepetition
+              + (screen.cooling ? cookTime : 0)
+              + screen.phaseTotal - remaining;
+  screen.total = repetitions * perRepetition;
+
+  cookScreenRender(lcd, screen);
+}
+
 // Muestra pantalla inicial con opciones
 void showInitialScreen() {
+  cookScreenReset();
   lcd.clear();
   lcd.setCursor(0, 0);
   lcd.print("A:Calen B:Descon");  // Programas A y B
@@ -526,6 +546,7 @@ void startCookingProgram(int programIndex, int cook, int cool, int reps) {
   lcd.clear();
   lcd.setCursor(0,0);
   lcd.print("   Comenzando   ");
+  cookScreenReset();
   finishBeepDone = false;
 }
 
@@ -548,7 +569,7 @@ void resetAfterCooking() {
   screenInitialized = false;
   prevState = WAITING;
   currentState = WAITING;
-  noTone(buzzerPin);
+  noTone(BuzzerPin::number);
   buzzerActive = false;
   finishBeepDone = false;
   buzzerActive = false;
@@ -560,6 +581,9 @@ void resetAfterCooking() {
 void checkCancel(char key) {
   if (key == '*') {
     if (currentState == CONFIGURING || currentState == COOKING || currentState == PAUSED) {
+      if (currentState != CONFIGURING) {
+        statsCount(STAT_CANCELLED);  // Cocción cancelada
+      }
       lcd.clear();
       lcd.print("Cancelado       ");
       delay(1000);
@@ -573,20 +597,16 @@ void checkCancel(char key) {
 
 // Actualiza la luz interior según estado
 void updateInteriorLight() {
-  bool doorOpen = digitalRead(doorPin) == LOW;  // True si puerta abierta
+  bool doorOpen = !DoorPin::read();  // True si puerta abierta
   bool cooking = (currentState == COOKING);     // True si está cocinando
 
   // Luz se enciende si puerta abierta o durante cocción
-  if (doorOpen || cooking) {
-    digitalWrite(lightPin, HIGH);
-  } else {
-    digitalWrite(lightPin, LOW);
-  }
+  LightPin::write(doorOpen || cooking);
 }
 
 // Maneja estado de puerta abierta
 void handleDoorOpenState() {
-  digitalWrite(lightPin, HIGH);  // Enciende luz siempre que la puerta está abierta
+  LightPin::high();  // Enciende luz siempre que la puerta está abierta
 
   // Muestra mensaje en LCD
   lcd.setCursor(0, 0);
@@ -616,7 +636,7 @@ void updateRotatingPattern() {
 
     // Dibuja la cola del patrón
     for (int i = 0; i < tailSize; i++) {
-      int index = (headIndex - i + ring.numPixels()) % ring.numPixels();
+      int index = (headIndex - i + numPixels) % numPixels;
       
       // Calcula brillo con atenuación
       int brightness = 255 - (i * 80); // Brillo decreciente
@@ -628,18 +648,18 @@ void updateRotatingPattern() {
     ring.show();  // Actualiza LEDs
 
     // Avanza la posición principal
-    headIndex = (headIndex + 1) % ring.numPixels();
+    headIndex = (headIndex + 1) % numPixels;
   }
 }
 
 // Función principal para manejar patrones del anillo
 void updatePlatePattern() {
   ring.clear();  // Apaga todos los LEDs
-  bool doorClosed = digitalRead(doorPin) == HIGH;
+  bool doorClosed = DoorPin::read();
   
   // Si puerta abierta, todos los LEDs en blanco
   if (!doorClosed) {
-    for(uint16_t i=0; i<ring.numPixels(); i++) {
+    for(uint16_t i=0; i<numPixels; i++) {
       ring.setPixelColor(i, ring.Color(255, 255, 255));
     }
     ring.show();
@@ -679,7 +699,7 @@ void updateBlinkingPattern() {
     if (currentMillis - previousMillis >= offDuration) {
       ledsOn = true;
       previousMillis = currentMillis;
-      for (unsigned int i = 0; i < ring.numPixels(); i++) {
+      for (unsigned int i = 0; i < numPixels; i++) {
         ring.setPixelColor(i, ring.Color(255, 255, 255));  // Blanco
       }
       ring.show();
@@ -693,8 +713,8 @@ void updateBuzzer() {
   unsigned long currentMillis = millis();
 
   // Silencia si la puerta está abierta
-  if (digitalRead(doorPin) == LOW) {
-    noTone(buzzerPin);
+  if (!DoorPin::read()) {
+    noTone(BuzzerPin::number);
     phaseSoundEnabled = false;
     return;
   }
@@ -717,18 +737,18 @@ void updateBuzzer() {
       // Sonido continuo durante la fase
       if (phaseSoundEnabled) {
         if (currentStep == 0) { // Tono de Calentamiento
-          tone(buzzerPin, HEATING_TONE);
+          tone(BuzzerPin::number, HEATING_TONE);
         } else { //Tono de Enfriamiento
-          tone(buzzerPin, COOLING_TONE);
+          tone(BuzzerPin::number, COOLING_TONE);
         }
       } else {
-        noTone(buzzerPin);
+        noTone(BuzzerPin::number);
       }
       
       beepCounter = 0;  // Resetea contador de beeps
       break;
     default:
-      noTone(buzzerPin);  // Silencia en otros estados
+      noTone(BuzzerPin::number);  // Silencia en otros estados
       break;
   }
 }
@@ -740,9 +760,29 @@ void handleFinishedBeep() {
   const int FINISH_PAUSE_DURATION = 500; // Pausa entre beeps
 
   for (int i = 0; i < 3; i++) {
-    tone(buzzerPin, FINISH_BEEP_FREQ);
+    tone(BuzzerPin::number, FINISH_BEEP_FREQ);
     delay(FINISH_BEEP_DURATION);
-    noTone(buzzerPin);
+    noTone(BuzzerPin::number);
     delay(FINISH_PAUSE_DURATION);
   }
-}
\ No newline at end of file
+}
+
+// Atiende comandos simples por el puerto serie
+//   s: imprime las estadísticas de uso
+//   f: fuerza el volcado de estadísticas a EEPROM
+//   m: imprime el uso de SRAM (heap, stack y mínimo libre)
+void handleSerialCommand() {
+  if (!Serial.available()) return;
+
+  switch (Serial.read()) {
+    case 's':
+      statsDump(Serial);
+      break;
+    case 'f':
+      statsFlush();
+      break;
+    case 'm':
+      memoryReport(Serial);
+      break;
+  }
+}
@@ -0,0 +1,111 @@
+#include "memstats.h"
+
+// Símbolos del enlazador y de malloc (avr-libc)
+extern uint8_t __stack;       // Tope de la RAM (RAMEND)
+extern char __heap_start;     // Comienzo del heap (fin de .bss/.noinit)
+extern char* __brkval;        // Tope actual del heap (0 si nunca se usó malloc)
+
+const uint8_t MEMORY_PAINT = 0xC5;                    // Patrón de pintado
+const unsigned long memoryCheckInterval = 1000;       // Muestreo cada 1 s
+
+unsigned long lastMemoryCheck = 0;  // Último muestreo
+bool memoryWarned = false;          // Aviso de margen bajo ya enviado
+
+// Pinta la RAM libre antes de los constructores globales. Va en .init3:
+// después de que .init2 deja SP en RAMEND y r1 en cero, y antes de que
+// .init6 corra los constructores (NeoPixel y String ya piden heap ahí).
+// Se ejecuta en línea dentro del código de arranque, sin call ni ret, por
+// eso es naked y el cuerpo es asm básico: no hay prólogo ni stack propio y
+// sólo toca registros que el arranque no necesita después (r24, r26-r31).
+// El 0xC5 del asm tiene que coincidir con MEMORY_PAINT.
+void memoryPaint() __attribute__((naked, used, section(".init3")));
+void memoryPaint() {
+  asm volatile(
+    "  ldi r30, lo8(__heap_start)  \n"
+    "  ldi r31, hi8(__heap_start)  \n"
+    "  ldi r26, lo8(__stack + 1)   \n"
+    "  ldi r27, hi8(__stack + 1)   \n"
+    "  ldi r24, 0xC5               \n"
+    "1:                            \n"
+    "  st  Z+, r24                 \n"
+    "  cp  r30, r26                \n"
+    "  cpc r31, r27                \n"
+    "  brne 1b                     \n"
+  );
+}
+
+// Tope actual del heap
+static uint8_t* heapTop() {
+  return __brkval ? (uint8_t*)__brkval : (uint8_t*)&__heap_start;
+}
+
+// Busca la tira más larga de bytes con el patrón intacto por debajo del
+// stack actual. Su comienzo es el tope más alto que alcanzó el heap y su
+// final el punto más bajo al que llegó el stack. No alcanza con contar desde
+// __brkval: baja cuando se libera el bloque de más arriba (los String
+// temporales) y deja restos sin patrón justo encima.
+static uint16_t untouchedRun(uint8_t** start) {
+  uint8_t marker;  // Vive en el stack: su dirección es el SP aproximado
+  uint8_t* p = (uint8_t*)&__heap_start;
+  uint16_t longest = 0;
+
+  *start = &marker;
+  while (p < &marker) {
+    if (*p != MEMORY_PAINT) {
+      p++;
+      continue;
+    }
+    uint8_t* run = p;
+    while (p < &marker && *p == MEMORY_PAINT) p++;
+    if ((uint16_t)(p - run) > longest) {
+      longest = p - run;
+      *start = run;
+    }
+  }
+  return longest;
+}
+
+uint16_t memoryFreeNow() {
+  uint8_t marker;
+  return &marker - heapTop();
+}
+
+uint16_t memoryMinFree() {
+  uint8_t* start;
+  return untouchedRun(&start);
+}
+
+// Avisa una vez si el margen entre heap y stack quedó chico
+void memoryUpdate() {
+  unsigned long now = millis();
+  if (now - lastMemoryCheck < memoryCheckInterval) return;
+  lastMemoryCheck = now;
+
+  if (!memoryWarned && memoryMinFree() < MEMORY_WARN_THRESHOLD) {
+    memoryWarned = true;
+    Serial.println(F("AVISO: poca SRAM libre"));
+    memoryReport(Serial);
+  }
+}
+
+// Los máximos salen de la zona pintada, así que incluyen los picos cortos
+// (temporales de String, llamadas profundas) que un muestreo no vería
+void memoryReport(Print& out) {
+  uint8_t* start;
+  uint16_t minFree = untouchedRun(&start);
+  uint16_t heapPeak = start - (uint8_t*)&__heap_start;
+  uint16_t stackPeak = &__stack - (start + minFree) + 1;
+
+  out.print(F("SRAM estatica: "));
+  out.println((uint8_t*)&__heap_start - (uint8_t*)RAMSTART);
+  out.print(F("Heap actual:   "));
+  out.println(heapTop() - (uint8_t*)&__heap_start);
+  out.print(F("Heap maximo:   "));
+  out.println(heapPeak);
+  out.print(F("Stack maximo:  "));
+  out.println(stackPeak);
+  out.print(F("Libre ahora:   "));
+  out.println(memoryFreeNow());
+  out.print(F("Libre minimo:  "));
+  out.println(minFree);
+}
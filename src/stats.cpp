@@ -0,0 +1,150 @@
+#include <EEPROM.h>
+#include "stats.h"
+
+//========== ZONA RESERVADA EN EEPROM ==========
+// Los programas ocupan el principio de la EEPROM; el anillo de estadísticas
+// va desde STATS_EEPROM_START hasta el final.
+//
+// Formato de cada registro (STATS_SLOT_SIZE bytes):
+//   [0]     secuencia (0-254, 0xFF = vacío)
+//   [1..2]  máscara de campos presentes (little endian, bit n = campo n)
+//   [3..]   un varint de 7 bits por campo presente, en orden de campo
+const int STATS_EEPROM_START = 64;
+const uint8_t STATS_SLOT_SIZE = 16;
+const uint8_t STATS_SLOTS = 60;
+const uint8_t STATS_EMPTY = 0xFF;
+const unsigned long statsFlushInterval = 30UL * 60UL * 1000UL;  // 30 minutos
+
+static_assert(STATS_EEPROM_START + STATS_SLOTS * STATS_SLOT_SIZE <= E2END + 1,
+              "El anillo de estadisticas no entra en la EEPROM");
+
+uint16_t statsPending[STAT_FIELDS];
+
+uint8_t statsHead = 0;               // Próximo registro a escribir
+uint8_t statsSeq = 0;                // Secuencia del próximo registro
+unsigned long lastStatsFlush = 0;    // Último volcado
+
+// Dirección del registro n
+static int slotAddress(uint8_t slot) {
+  return STATS_EEPROM_START + slot * STATS_SLOT_SIZE;
+}
+
+// Secuencia siguiente (salta 0xFF, que marca un registro vacío)
+static uint8_t nextSeq(uint8_t seq) {
+  return seq >= 254 ? 0 : seq + 1;
+}
+
+// Codifica lo pendiente en un registro. Los campos que no entran quedan
+// para el próximo. Devuelve la máscara de campos incluidos.
+static uint16_t encodeRecord(uint8_t* slot, uint8_t seq) {
+  uint16_t mask = 0;
+  uint8_t pos = 3;
+
+  memset(slot, 0, STATS_SLOT_SIZE);
+  slot[0] = seq;
+
+  for (uint8_t field = 0; field < STAT_FIELDS; field++) {
+    uint16_t value = statsPending[field];
+    if (value == 0) continue;
+
+    uint8_t len = value < 0x80 ? 1 : (value < 0x4000 ? 2 : 3);
+    if (pos + len > STATS_SLOT_SIZE) continue;
+
+    while (value >= 0x80) {
+      slot[pos++] = (value & 0x7F) | 0x80;
+      value >>= 7;
+    }
+    slot[pos++] = value;
+    mask |= 1U << field;
+  }
+
+  slot[1] = mask & 0xFF;
+  slot[2] = mask >> 8;
+  return mask;
+}
+
+// Busca dónde quedó el anillo: el primer registro que no sigue la secuencia
+void statsBegin() {
+  uint8_t last = EEPROM.read(slotAddress(0));
+  statsHead = 0;
+  statsSeq = 0;
+  lastStatsFlush = millis();
+
+  if (last == STATS_EMPTY) return;  // Anillo sin usar
+
+  for (uint8_t i = 1; i < STATS_SLOTS; i++) {
+    uint8_t seq = EEPROM.read(slotAddress(i));
+    if (seq != nextSeq(last)) {
+      statsHead = i;
+      statsSeq = nextSeq(last);
+      return;
+    }
+    last = seq;
+  }
+
+  // Anillo lleno y el más nuevo es el último: se vuelve al principio
+  statsSeq = nextSeq(last);
+}
+
+// Escribe todo lo pendiente (normalmente un solo registro)
+void statsFlush() {
+  uint8_t slot[STATS_SLOT_SIZE];
+
+  for (;;) {
+    uint16_t mask = encodeRecord(slot, statsSeq);
+    if (mask == 0) break;  // Nada pendiente
+
+    // La secuencia va al final: si se corta la luz a mitad de la escritura
+    // el registro queda marcado vacío en lugar de mezclar datos viejos y nuevos
+    int address = slotAddress(statsHead);
+    EEPROM.update(address, STATS_EMPTY);
+    for (uint8_t i = 1; i < STATS_SLOT_SIZE; i++) {
+      EEPROM.update(address + i, slot[i]);  // Sólo graba los bytes distintos
+    }
+    EEPROM.update(address, slot[0]);
+
+    for (uint8_t field = 0; field < STAT_FIELDS; field++) {
+      if (mask & (1U << field)) statsPending[field] = 0;
+    }
+    statsHead = (statsHead + 1) % STATS_SLOTS;
+    statsSeq = nextSeq(statsSeq);
+  }
+
+  lastStatsFlush = millis();
+}
+
+// Vuelca a EEPROM sólo en reposo y como mucho una vez por intervalo
+void statsUpdate(bool idle) {
+  if (!idle) return;
+  if (millis() - lastStatsFlush < statsFlushInterval) return;
+  statsFlush();
+}
+
+// Imprime los registros del más viejo al más nuevo y después lo pendiente.
+// tools/stats_decode.py interpreta esta salida.
+void statsDump(Print& out) {
+  out.println(F("STATS BEGIN"));
+
+  for (uint8_t n = 0; n < STATS_SLOTS; n++) {
+    int address = slotAddress((statsHead + n) % STATS_SLOTS);
+    if (EEPROM.read(address) == STATS_EMPTY) continue;
+
+    out.print('R');
+    for (uint8_t i = 0; i < STATS_SLOT_SIZE; i++) {
+      uint8_t value = EEPROM.read(address + i);
+      out.print(' ');
+      if (value < 0x10) out.print('0');
+      out.print(value, HEX);
+    }
+    out.println();
+  }
+
+  out.print('P');
+  for (uint8_t field = 0; field < STAT_FIELDS; field++) {
+    out.print(' ');
+    out.print(statsPending[field]);
+  }
+  out.println();
+
+  out.println(F("STATS END"));
+}
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""Decodifica el volcado de estadísticas del microondas (comando 's' por serie).
+
+Uso:
+    python3 tools/stats_decode.py volcado.txt
+    python3 tools/stats_decode.py < volcado.txt
+
+Cada línea 'R' es un registro del anillo en EEPROM (ver src/stats.cpp):
+secuencia, máscara de campos de 16 bits y un varint de 7 bits por campo.
+La línea 'P' trae los contadores que todavía no se volcaron.
+"""
+
+import sys
+
+FIELDS = (
+    ["Programa " + c for c in "ABCD"]
+    + ["Rapida %d s" % n for n in range(1, 10)]
+    + ["Segundos de magnetron", "Puerta abierta cocinando", "Canceladas"]
+)
+STARTS = range(0, 13)        # Campos que cuentan inicios de cocción
+CANCELLED = 15
+SLOT_SIZE = 16               # Bytes por registro (STATS_SLOT_SIZE)
+
+
+def decode_record(data):
+    """Devuelve (secuencia, lista de deltas) de un registro.
+
+    Lanza ValueError si el registro está incompleto o corrupto.
+    """
+    if len(data) != SLOT_SIZE:
+        raise ValueError("registro de %d bytes" % len(data))
+    seq = data[0]
+    mask = data[1] | (data[2] << 8)
+    deltas = [0] * len(FIELDS)
+    pos = 3
+    for field in range(len(FIELDS)):
+        if not mask & (1 << field):
+            continue
+        value, shift = 0, 0
+        while True:
+            if pos >= SLOT_SIZE:
+                raise ValueError("varint fuera del registro")
+            byte = data[pos]
+            pos += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                break
+        deltas[field] = value
+    return seq, deltas
+
+
+def main():
+    source = open(sys.argv[1]) if len(sys.argv) > 1 else sys.stdin
+    totals = [0] * len(FIELDS)
+    records = 0
+
+    for line in source:
+        parts = line.split()
+        if not parts:
+            continue
+        if parts[0] == "R":
+            try:
+                seq, deltas = decode_record(bytes(int(b, 16) for b in parts[1:]))
+            except ValueError as error:
+                print("registro descartado: %s" % error)
+                continue
+            print("registro %3d: %s" % (seq, " ".join(str(d) for d in deltas)))
+            records += 1
+        elif parts[0] == "P":
+            deltas = [int(v) for v in parts[1:]]
+            print("pendiente   : %s" % " ".join(str(d) for d in deltas))
+        else:
+            continue
+        totals = [t + d for t, d in zip(totals, deltas)]
+
+    print()
+    print("Totales (%d registros + pendiente):" % records)
+    for name, total in zip(FIELDS, totals):
+        print("  %-26s %d" % (name, total))
+
+    starts = sum(totals[i] for i in STARTS)
+    if starts:
+        print("  %-26s %.1f %%" % ("Tasa de cancelacion",
+                                    100.0 * totals[CANCELLED] / starts))
+
+
+if __name__ == "__main__":
+    main()